@@ -27,16 +27,22 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <sys/types.h>
 #include <ladspa.h>
 
 class LADSPAInfo
 {
 public:
+	struct LibraryCache;
+
 // If override is false, examine $LADSPA_PATH
 // Also examine supplied path list
 // For all paths, add basic plugin information for later lookup,
 // instantiation and so on.
-	LADSPAInfo(bool override = false, const char *path_list = "");
+// If cache is given, libraries it has up to date entries for are not
+// examined again.
+	LADSPAInfo(bool override = false, const char *path_list = "",
+	           const LibraryCache *cache = NULL);
 
 // Unload all loaded plugins and clean up
 	~LADSPAInfo();
@@ -111,10 +117,25 @@ public:
                   unsigned int AudioInputs;
             unsigned int AudioOutputs;
             const LADSPA_Descriptor    *Descriptor;     // Descriptor, NULL
+		unsigned long               InputPorts;     // Number of input ports
+	};
 
-            
+// What was found in a library, and the modification time and size
+// of the library when it was examined
+	struct LibraryCacheEntry
+	{
+		time_t                      MTime;
+		off_t                       Size;
+		std::vector<PluginInfo>     Plugins;        // LibraryIndex unused
 	};
 
+// Keyed by the full path of the library
+	struct LibraryCache : public std::map<std::string, LibraryCacheEntry> { };
+
+// Get what was found in each library examined by the last scan,
+// suitable for giving to the constructor next time
+	const LibraryCache             &GetLibraryCache(void) { return m_LibraryCache; }
+
 // Get ordered list of plugin names and IDs for plugin menu
 	const std::vector<PluginEntry>  GetMenuList(void);
         
@@ -141,6 +162,9 @@ private:
 	                                                                             const std::string));
 	void                            ExaminePluginLibrary(const std::string path,
 	                                                     const std::string basename);
+	void                            AddPluginLibrary(const std::string path,
+	                                                 const std::string basename,
+	                                                 const std::vector<PluginInfo> &plugins);
 
 	bool                            CheckPlugin(const LADSPA_Descriptor *desc);
 	LADSPA_Descriptor_Function      GetDescriptorFunctionForLibrary(unsigned long library_index);
@@ -187,6 +211,11 @@ private:
 	std::vector<LibraryInfo>        m_Libraries;
 	std::vector<PluginInfo>         m_Plugins;
 
+// Library cache given to the constructor, and the one built by the
+// last scan
+	LibraryCache                    m_OldCache;
+	LibraryCache                    m_LibraryCache;
+
 // Plugin lookup maps
 	IDMap                           m_IDLookup;
 
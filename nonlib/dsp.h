@@ -38,8 +38,10 @@ void buffer_interleaved_copy ( sample_t *__restrict__ dst, const sample_t * __re
 void buffer_fill_with_silence ( sample_t *buf, nframes_t nframes );
 bool buffer_is_digital_black ( const sample_t *buf, nframes_t nframes );
 float buffer_get_peak ( const sample_t *buf, nframes_t nframes );
+void buffer_get_peak_and_power ( const sample_t *buf, nframes_t nframes, float *peak, float *power );
 void buffer_copy ( sample_t *dst, const sample_t *src, nframes_t nframes );
 void buffer_copy_and_apply_gain ( sample_t *dst, const sample_t *src, nframes_t nframes, float gain );
+void buffer_interleaved_min_max ( float *mins, float *maxs, const sample_t *src, int channels, nframes_t nframes );
 
 class Value_Smoothing_Filter
 {
@@ -65,6 +67,77 @@ public:
 
 };
 
+/* A delay of up to capacity() - nframes frames, applied in place,
+ * where nframes is the most processed at once. The delay may be
+ * changed from another thread while it's being applied, in which
+ * case the history is lost */
+class Delay_Line
+{
+    sample_t *_buf;
+    nframes_t _size;
+    nframes_t _w;
+
+    volatile nframes_t _delay;
+    nframes_t _current;
+
+    /* not allowed */
+    Delay_Line ( const Delay_Line &rhs );
+    Delay_Line & operator = ( const Delay_Line &rhs );
+
+public:
+
+    Delay_Line ( nframes_t capacity );
+    ~Delay_Line ( );
+
+    nframes_t capacity ( void ) const { return _size; }
+
+    nframes_t delay ( void ) const { return _delay; }
+    void delay ( nframes_t v ) { _delay = v; }
+
+    void apply ( sample_t *buf, nframes_t nframes );
+};
+
+/* Measures the peak, power and, optionally, true peak (the peak of
+ * the signal reconstructed between samples, estimated by 4x
+ * oversampling as in ITU-R BS.1770) of a channel, all in one pass
+ * over each buffer */
+class Level_Meter
+{
+public:
+
+    enum { OVERSAMPLING = 4, TAPS = 12 };
+
+    struct levels
+    {
+        float peak;
+        /* sum of the squares of the samples */
+        float power;
+        /* 0 unless true peak is enabled */
+        float true_peak;
+    };
+
+private:
+
+    static float _coefficients[ OVERSAMPLING ][ TAPS ];
+    static bool _coefficients_ready;
+
+    static void init_coefficients ( void );
+
+    /* the last TAPS - 1 input samples */
+    sample_t _history[ TAPS - 1 ];
+
+    bool _true_peak;
+
+public:
+
+    Level_Meter ( );
+
+    bool true_peak ( void ) const { return _true_peak; }
+    void true_peak ( bool v );
+
+    void process ( const sample_t *buf, nframes_t nframes, levels *l );
+};
+
 static inline float interpolate_cubic ( const float fr, const float inm1, const float in, const float inp1, const float inp2)
 {
     return in + 0.5f * fr * (inp1 - inm1 +
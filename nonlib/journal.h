@@ -0,0 +1,151 @@
+
+/*******************************************************************************/
+/* Copyright (C) 2013 Jonathan Moore Liles                                     */
+/*                                                                             */
+/* This program is free software; you can redistribute it and/or modify it     */
+/* under the terms of the GNU General Public License as published by the       */
+/* Free Software Foundation; either version 2 of the License, or (at your      */
+/* option) any later version.                                                  */
+/*                                                                             */
+/* This program is distributed in the hope that it will be useful, but WITHOUT */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for   */
+/* more details.                                                               */
+/*                                                                             */
+/* You should have received a copy of the GNU General Public License along     */
+/* with This program; see the file COPYING.  If not,write to the Free Software */
+/* Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.  */
+/*******************************************************************************/
+
+
+/* Encoding and decoding of Loggable journals. Journals are either
+ * text, one "Class 0xID command :name value ... << :name value ..."
+ * entry per line with multi-entry transactions braced by "{" and
+ * "}", or binary.
+ *
+ * A binary journal begins with JOURNAL_MAGIC and is followed by a
+ * sequence of records. Each record is framed by its length on both
+ * sides, so that it can be read backwards for undo:
+ *
+ *    uint32 size, uint8 kind, payload[ size - 1 ], uint32 size
+ *
+ * Class and field names are each written once per file, in a name
+ * record holding the name and the index by which the records after
+ * it refer to it. An entry record's payload holds the command, object
+ * id and the index of its class name, followed by the new and old
+ * states as lists of name indices and typed values. Multi-byte values
+ * are stored in host byte order, as with peakfiles.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+class Log_Entry;
+
+#define JOURNAL_MAGIC "NJNL\x02\0\0\0"
+const size_t journal_magic_size = 8;
+
+enum journal_record_kind { JOURNAL_BLOCK_START = 1,
+                           JOURNAL_BLOCK_END,
+                           JOURNAL_ENTRY,
+                           JOURNAL_NAME };
+
+enum journal_command { JOURNAL_CREATE = 1,
+                       JOURNAL_SET,
+                       JOURNAL_DESTROY };
+
+enum journal_value_type { JOURNAL_INT = 1,
+                          JOURNAL_FRAME,
+                          JOURNAL_FLOAT,
+                          JOURNAL_DOUBLE,
+                          JOURNAL_ID,
+                          JOURNAL_STRING,
+                          /* anything that doesn't survive a round trip as one of the above */
+                          JOURNAL_RAW };
+
+/* growable byte buffer */
+struct journal_buffer
+{
+    char *data;
+    size_t len;
+    size_t size;
+};
+
+void journal_buffer_init ( journal_buffer *b );
+void journal_buffer_free ( journal_buffer *b );
+char *journal_buffer_reserve ( journal_buffer *b, size_t n );
+void journal_buffer_append ( journal_buffer *b, const void *p, size_t n );
+
+/* the names defined by the name records of one binary journal (or
+ * snapshot), in order, and their indices for looking them up when
+ * writing one */
+struct journal_names
+{
+    std::vector <char *> names;
+    std::map <std::string, unsigned int> index;
+
+    journal_names ( ) { }
+    ~journal_names ( );
+
+private:
+
+    journal_names ( const journal_names &rhs );
+    journal_names & operator= ( const journal_names &rhs );
+};
+
+void journal_names_clear ( journal_names *d );
+bool journal_decode_name ( const char *payload, size_t len, journal_names *d );
+bool journal_read_names ( const char *buf, size_t len, journal_names *d );
+
+/* one text journal line, split in place */
+struct journal_line
+{
+    char *class_name;
+    unsigned int id;
+    char *command;
+    char *args;                                                 /* NULL if empty */
+    char *old_args;                                             /* the part after "<<", NULL if empty */
+};
+
+char *journal_find_reverse ( char *s );
+bool journal_parse_line ( char *s, journal_line *l );
+
+const char *journal_command_name ( int command );
+int journal_command_from_name ( const char *name );
+
+bool journal_is_binary ( const char *buf, size_t len );
+bool journal_is_unsupported ( const char *buf, size_t len );
+size_t journal_record_size ( const char *record );
+size_t journal_entry_size ( const char *records );
+
+void journal_encode_marker ( journal_buffer *b, int kind );
+void journal_encode_entry ( journal_buffer *b, journal_names *d, const char *class_name, unsigned int id, int command, const Log_Entry *n, const Log_Entry *o );
+bool journal_encode_line ( journal_buffer *b, journal_names *d, char *line );
+
+/* a decoded entry record. The pairs are still encoded */
+struct journal_entry
+{
+    const journal_names *names;
+    int command;
+    unsigned int id;
+    const char *class_name;
+    size_t class_name_len;
+    int nn;                                                     /* number of new pairs */
+    int no;                                                     /* number of old pairs */
+    const char *pairs;
+    const char *end;
+};
+
+size_t journal_next_record ( const char *buf, size_t len, int *kind, const char **payload, size_t *payload_len );
+bool journal_decode_entry ( const char *payload, size_t len, const journal_names *d, journal_entry *e );
+int journal_decode_pairs ( const journal_entry *e, bool old, journal_buffer *scratch, char **sa, bool text = false );
+void journal_print_entry ( journal_buffer *b, const journal_entry *e );
+
+bool journal_convert ( char *buf, size_t len, FILE *out, bool binary );
+bool journal_compact ( char *buf, size_t len, FILE *out );